@@ -22,6 +22,7 @@
 //  THE SOFTWARE.
 
 #import "RBDateTime.h"
+#import "RBDateTimeStatistics+Private.h"
 
 
 @implementation RBDateTime (Formatting)
@@ -63,13 +64,20 @@ static NSDateFormatter *_formatter = nil;
                                   timeZone:(NSTimeZone *)timeZone
                                     locale:(NSLocale *)locale {
     [RBDateTime _initializeDateFormatter];
+    // Converted before the timer starts, so that a cache miss is only counted as calendar time.
+    NSDate *date = self.NSDate;
+    RBStatisticsIncrement(formatterReconfigurations);
+    RBStatisticsTimerStart(timer);
 
     _formatter.dateStyle = dateStyle;
     _formatter.timeStyle = timeStyle;
     _formatter.timeZone = timeZone != nil ? timeZone : self.timeZone;
     _formatter.locale = locale;
 
-    return [_formatter stringFromDate:self.NSDate];
+    NSString *string = [_formatter stringFromDate:date];
+
+    RBStatisticsTimerStop(timer, formatterNanoseconds);
+    return string;
 }
 
 - (NSString *)localizedStringWithFormatTemplate:(NSString *)formatTemplate {
@@ -87,6 +95,9 @@ static NSDateFormatter *_formatter = nil;
                                        timeZone:(NSTimeZone *)timeZone
                                          locale:(NSLocale *)locale {
     [RBDateTime _initializeDateFormatter];
+    NSDate *date = self.NSDate;
+    RBStatisticsIncrement(formatterReconfigurations);
+    RBStatisticsTimerStart(timer);
 
     _formatter.dateFormat = [NSDateFormatter dateFormatFromTemplate:formatTemplate
                                                             options:0
@@ -94,7 +105,10 @@ static NSDateFormatter *_formatter = nil;
     _formatter.timeZone = timeZone != nil ? timeZone : self.timeZone;
     _formatter.locale = locale;
 
-    return [_formatter stringFromDate:self.NSDate];
+    NSString *string = [_formatter stringFromDate:date];
+
+    RBStatisticsTimerStop(timer, formatterNanoseconds);
+    return string;
 }
 
 - (NSString *)localizedStringWithFormat:(NSString *)format {
@@ -113,12 +127,18 @@ static NSDateFormatter *_formatter = nil;
                                timeZone:(NSTimeZone *)timeZone
                                  locale:(NSLocale *)locale {
     [RBDateTime _initializeDateFormatter];
+    NSDate *date = self.NSDate;
+    RBStatisticsIncrement(formatterReconfigurations);
+    RBStatisticsTimerStart(timer);
 
     _formatter.dateFormat = format;
     _formatter.timeZone = timeZone != nil ? timeZone : self.timeZone;
     _formatter.locale = locale;
 
-    return [_formatter stringFromDate:self.NSDate];
+    NSString *string = [_formatter stringFromDate:date];
+
+    RBStatisticsTimerStop(timer, formatterNanoseconds);
+    return string;
 }
 
 + (void)setDefaultDateStyle:(NSDateFormatterStyle)dateStyle {
@@ -184,11 +204,16 @@ static NSDateFormatter *_formatter = nil;
 + (instancetype)dateTimeByParsingString:(NSString *)string withFormat:(NSString *)format
                                timeZone:(NSTimeZone *)timeZone {
     [RBDateTime _initializeDateFormatter];
+    RBStatisticsIncrement(formatterReconfigurations);
+    RBStatisticsTimerStart(timer);
+
     _formatter.dateFormat = format;
     _formatter.timeZone = timeZone != nil ? timeZone : [NSTimeZone localTimeZone];
 
     NSDate *parsedDate = [_formatter dateFromString:string];
 
+    RBStatisticsTimerStop(timer, formatterNanoseconds);
+
     if (parsedDate) {
         return [RBDateTime dateTimeWithNSDate:parsedDate calendar:nil timezone:_formatter.timeZone];
     } else {
@@ -207,11 +232,16 @@ static NSDateFormatter *_formatter = nil;
 
 + (instancetype)dateTimeByParsingUnixTimestamp:(NSString *)unixTimestamp timeZone:(NSTimeZone *)timeZone {
     [RBDateTime _initializeDateFormatter];
+    RBStatisticsIncrement(formatterReconfigurations);
+    RBStatisticsTimerStart(timer);
+
     _formatter.dateFormat = kUnixTimeStampFormat;
     _formatter.timeZone = timeZone != nil ? timeZone : [NSTimeZone localTimeZone];
 
     NSDate *parsedDate = [_formatter dateFromString:unixTimestamp];
 
+    RBStatisticsTimerStop(timer, formatterNanoseconds);
+
     if (parsedDate) {
         return [RBDateTime dateTimeWithNSDate:parsedDate calendar:nil timezone:_formatter.timeZone];
     } else {
@@ -22,6 +22,7 @@
 //  THE SOFTWARE.
 
 #import "RBDateTime.h"
+#import "RBDateTimeStatistics+Private.h"
 
 
 @interface RBDateTime () {
@@ -73,6 +74,8 @@ static double kNanosecondsInMillisecond = 1000000;
                       timeZone:(NSTimeZone *)timeZone {
     self = [super init];
     if (self) {
+        RBStatisticsIncrement(dateTimesCreated);
+
         _nsDateTime = date;
         _components = [NSDateComponents new];
 
@@ -90,6 +93,8 @@ static double kNanosecondsInMillisecond = 1000000;
                                               timeZone:(NSTimeZone *)timeZone {
     self = [super init];
     if (self) {
+        RBStatisticsIncrement(dateTimesCreated);
+
         _nsDateTime = [NSDate dateWithTimeIntervalSinceReferenceDate:seconds];
         _components = [NSDateComponents new];
 
@@ -109,6 +114,8 @@ static double kNanosecondsInMillisecond = 1000000;
                     timeZone:(NSTimeZone *)timeZone {
     self = [super init];
     if (self) {
+        RBStatisticsIncrement(dateTimesCreated);
+
         _components = [[NSDateComponents alloc] init];
 
         _components.year = year;
@@ -206,6 +213,8 @@ static double kNanosecondsInMillisecond = 1000000;
 - (instancetype)_initWithComponents:(NSDateComponents *)components requireValidation:(BOOL)requireValidation {
     self = [super init];
     if (self) {
+        RBStatisticsIncrement(dateTimesCreated);
+
         _components = components;
         _components.calendar.timeZone = components.timeZone;
 
@@ -230,11 +239,19 @@ static double kNanosecondsInMillisecond = 1000000;
 }
 
 - (void)_generateNSDateCacheFromComponents {
+    RBStatisticsIncrement(dateFromComponentsConversions);
+    RBStatisticsTimerStart(timer);
+
     self.calendar.timeZone = self.timeZone;
     _nsDateTime = [self.calendar dateFromComponents:_components];
+
+    RBStatisticsTimerStop(timer, dateFromComponentsNanoseconds);
 }
 
 - (void)_generateComponentsFromNSDate {
+    RBStatisticsIncrement(componentsFromDateConversions);
+    RBStatisticsTimerStart(timer);
+
     self.calendar.timeZone = self.timeZone;
     NSDateComponents *newComps = [self.calendar components:kValidCalendarUnits
                                                   fromDate:_nsDateTime];
@@ -242,11 +259,18 @@ static double kNanosecondsInMillisecond = 1000000;
     newComps.timeZone = _components.timeZone;
 
     _components = newComps;
+
+    RBStatisticsTimerStop(timer, componentsFromDateNanoseconds);
 }
 
 - (void)_validateComponents {
+    RBStatisticsIncrement(componentValidations);
+    RBStatisticsTimerStart(timer);
+
     [self _generateNSDateCacheFromComponents];
     [self _generateComponentsFromNSDate];
+
+    RBStatisticsTimerStop(timer, componentValidationNanoseconds);
 }
 
 
@@ -255,6 +279,7 @@ static double kNanosecondsInMillisecond = 1000000;
 
 - (NSDate *)NSDate {
     if (_nsDateTime == nil) {
+        RBStatisticsIncrement(dateCacheMisses);
         [self _generateNSDateCacheFromComponents];
     }
 
@@ -445,10 +470,15 @@ static double kNanosecondsInMillisecond = 1000000;
 }
 
 - (instancetype)dateTimeInTimeZone:(NSTimeZone *)targetTimeZone {
+    RBStatisticsIncrement(componentsFromDateConversions);
+    RBStatisticsTimerStart(timer);
+
     NSCalendar *tempCalendar = [_components.calendar copy];
     tempCalendar.timeZone = targetTimeZone != nil ? targetTimeZone : [NSTimeZone localTimeZone];
     NSDateComponents *newComps = [tempCalendar components:kValidCalendarUnits fromDate:_nsDateTime];
 
+    RBStatisticsTimerStop(timer, componentsFromDateNanoseconds);
+
     return [[RBDateTime alloc] _initWithComponents:newComps requireValidation:YES];
 }
 
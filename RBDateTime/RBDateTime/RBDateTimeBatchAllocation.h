@@ -0,0 +1,69 @@
+//
+//  RBDateTime
+//
+//  Copyright (c) 2015 Richard Bao. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "RBDateTime.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Recycles instances in @c +performBatchAllocation: when set to 1 at compile time. When it is 0
+/// (the default), no allocation overrides are compiled in and batches simply run their block.
+#ifndef RBDATETIME_BATCH_ALLOCATION
+#define RBDATETIME_BATCH_ALLOCATION 0
+#endif
+
+@interface RBDateTime (BatchAllocation)
+
+/// Returns whether instances are recycled by @c +performBatchAllocation:. This requires building with
+/// @c RBDATETIME_BATCH_ALLOCATION set to 1 and the Apple Objective-C runtime, which is the only one
+/// that can construct instances in place; otherwise the block simply runs.
++ (BOOL)batchAllocationAvailable;
+
+/// Runs a given block with batch allocation enabled on the current thread.
+///
+/// While the block runs, @c RBDateTime and @c RBDuration instances that are deallocated on this
+/// thread are kept in a per-thread free list instead of being freed, and new instances are built
+/// in their memory instead of being allocated. The free lists are released when the outermost
+/// batch ends. Instances may safely outlive the block; they are freed as usual when deallocated
+/// later.
+///
+/// Only the memory of the @c RBDateTime and @c RBDuration instances themselves is recycled. The
+/// @c NSDateComponents, @c NSDate and calendar objects created by operations such as
+/// @c -dateTimeByAddingDays: or @c -date are still allocated and freed as usual, and ARC retain and
+/// release traffic is unchanged.
+///
+/// Recycling is installed the first time this method is called. From then on, allocating and
+/// deallocating either class goes through an override instead of the runtime's fast path, also
+/// outside of batches.
+///
+/// The block runs inside an autorelease pool. Temporary instances are only recycled once they are
+/// deallocated, so loops creating many of them should drain an autorelease pool per iteration.
+///
+/// Batches may be nested.
+///
+/// @param  block           The block to run.
++ (void)performBatchAllocation:(void (^)(void))block;
+
+
+@end
+
+NS_ASSUME_NONNULL_END
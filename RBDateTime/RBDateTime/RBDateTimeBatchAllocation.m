@@ -0,0 +1,180 @@
+//
+//  RBDateTime
+//
+//  Copyright (c) 2015 Richard Bao. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+// This file must be compiled without ARC (-fno-objc-arc), since it constructs and destroys
+// instances in place.
+
+#import "RBDateTimeBatchAllocation.h"
+#import "RBDateTimeStatistics+Private.h"
+
+#if RBDATETIME_BATCH_ALLOCATION && defined(__APPLE__)
+#import <objc/runtime.h>
+#define RBRecyclingAvailable 1
+#else
+#define RBRecyclingAvailable 0
+#endif
+
+#if __has_feature(objc_arc)
+#error RBDateTimeBatchAllocation.m must be compiled with -fno-objc-arc.
+#endif
+
+
+#if RBRecyclingAvailable
+
+/// Upper bound of recycled instances kept per class and thread.
+static const NSUInteger kMaximumRecycledInstances = 1024;
+
+typedef struct RBRecycledInstance {
+    struct RBRecycledInstance *next;
+} RBRecycledInstance;
+
+typedef struct {
+    RBRecycledInstance *head;
+    NSUInteger count;
+} RBFreeList;
+
+static __thread NSUInteger RBBatchDepth = 0;
+static __thread RBFreeList RBDateTimeFreeList;
+static __thread RBFreeList RBDurationFreeList;
+
+/// Implementations of the superclass that the recycling overrides fall back to.
+static IMP RBSuperAllocWithZone = NULL;
+static IMP RBSuperDealloc = NULL;
+
+/// The recycled classes. Cached once the overrides are installed, since the overrides stay in place
+/// for good and run for every instance, inside batches or not.
+static Class RBDateTimeClass = Nil;
+static Class RBDurationClass = Nil;
+
+static RBFreeList *RBFreeListForClass(Class cls) {
+    if (cls == RBDateTimeClass) {
+        return &RBDateTimeFreeList;
+    } else if (cls == RBDurationClass) {
+        return &RBDurationFreeList;
+    } else {
+        return NULL;
+    }
+}
+
+static id RBRecyclingAllocWithZone(Class self, SEL _cmd, NSZone *zone) {
+    RBFreeList *freeList = RBFreeListForClass(self);
+
+    if (freeList == NULL || freeList->head == NULL) {
+        return ((id (*)(Class, SEL, NSZone *))RBSuperAllocWithZone)(self, _cmd, zone);
+    }
+
+    RBRecycledInstance *instance = freeList->head;
+    freeList->head = instance->next;
+    freeList->count--;
+
+    memset(instance, 0, class_getInstanceSize(self));
+    RBStatisticsIncrement(instancesRecycled);
+
+    return objc_constructInstance(self, instance);
+}
+
+/// Destroys the instance and keeps its memory for reuse while a batch is running on this thread and
+/// the free list is not full. Otherwise the instance is deallocated as usual.
+static void RBRecyclingDealloc(id self, SEL _cmd) {
+    RBFreeList *freeList = RBFreeListForClass(object_getClass(self));
+
+    if (freeList == NULL || RBBatchDepth == 0 || freeList->count >= kMaximumRecycledInstances) {
+        ((void (*)(id, SEL))RBSuperDealloc)(self, _cmd);
+        return;
+    }
+
+    objc_destructInstance(self);
+
+    RBRecycledInstance *instance = (RBRecycledInstance *)self;
+    instance->next = freeList->head;
+    freeList->head = instance;
+    freeList->count++;
+}
+
+static void RBReleaseFreeList(RBFreeList *freeList) {
+    while (freeList->head != NULL) {
+        RBRecycledInstance *instance = freeList->head;
+        freeList->head = instance->next;
+        free(instance);
+    }
+    freeList->count = 0;
+}
+
+/// Adds the recycling overrides to the given class. Neither RBDateTime nor RBDuration implements
+/// +allocWithZone: or -dealloc, and both inherit them directly from NSObject.
+static void RBInstallRecycling(Class cls) {
+    Method allocWithZone = class_getClassMethod([NSObject class], @selector(allocWithZone:));
+    Method dealloc = class_getInstanceMethod([NSObject class], @selector(dealloc));
+
+    class_addMethod(object_getClass(cls), @selector(allocWithZone:),
+                    (IMP)RBRecyclingAllocWithZone, method_getTypeEncoding(allocWithZone));
+    class_addMethod(cls, @selector(dealloc), (IMP)RBRecyclingDealloc, method_getTypeEncoding(dealloc));
+}
+
+#endif
+
+
+@implementation RBDateTime (BatchAllocation)
+
++ (BOOL)batchAllocationAvailable {
+    return RBRecyclingAvailable != 0;
+}
+
++ (void)performBatchAllocation:(void (^)(void))block {
+#if RBRecyclingAvailable
+    // Overriding +allocWithZone: opts the classes out of the runtime's fast allocation path, so the
+    // overrides are only added once batch allocation is used for the first time.
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        RBSuperAllocWithZone = method_getImplementation(class_getClassMethod([NSObject class],
+                                                                             @selector(allocWithZone:)));
+        RBSuperDealloc = method_getImplementation(class_getInstanceMethod([NSObject class], @selector(dealloc)));
+
+        RBDateTimeClass = [RBDateTime class];
+        RBDurationClass = [RBDuration class];
+
+        RBInstallRecycling(RBDateTimeClass);
+        RBInstallRecycling(RBDurationClass);
+    });
+
+    RBBatchDepth++;
+    @try {
+        @autoreleasepool {
+            block();
+        }
+    } @finally {
+        RBBatchDepth--;
+        if (RBBatchDepth == 0) {
+            RBReleaseFreeList(&RBDateTimeFreeList);
+            RBReleaseFreeList(&RBDurationFreeList);
+        }
+    }
+#else
+    @autoreleasepool {
+        block();
+    }
+#endif
+}
+
+
+@end
@@ -0,0 +1,59 @@
+//
+//  RBDateTime
+//
+//  Copyright (c) 2015 Richard Bao. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "RBDateTimeStatistics.h"
+
+// Internal instrumentation macros shared by the RBDateTime and RBDuration implementation files.
+
+#if RBDATETIME_STATISTICS
+
+#include <stdatomic.h>
+
+extern __thread RBDateTimeStatistics RBDateTimeThreadStatistics;
+/// Written by @c +setStatisticsTimingEnabled: on any thread and read on every measured call.
+extern atomic_bool RBDateTimeStatisticsTimingEnabled;
+
+/// Returns a monotonic time in nanoseconds.
+uint64_t RBDateTimeStatisticsNanoseconds(void);
+
+#define RBStatisticsIncrement(counter) \
+    (RBDateTimeThreadStatistics.counter++)
+
+#define RBStatisticsTimerStart(timer) \
+    uint64_t timer = atomic_load_explicit(&RBDateTimeStatisticsTimingEnabled, memory_order_relaxed) \
+        ? RBDateTimeStatisticsNanoseconds() : 0
+
+#define RBStatisticsTimerStop(timer, counter) \
+    do { \
+        if (timer != 0) { \
+            RBDateTimeThreadStatistics.counter += RBDateTimeStatisticsNanoseconds() - timer; \
+        } \
+    } while (0)
+
+#else
+
+#define RBStatisticsIncrement(counter)          do {} while (0)
+#define RBStatisticsTimerStart(timer)           do {} while (0)
+#define RBStatisticsTimerStop(timer, counter)   do {} while (0)
+
+#endif
@@ -0,0 +1,93 @@
+//
+//  RBDateTime
+//
+//  Copyright (c) 2015 Richard Bao. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "RBDateTime.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Collects hot path statistics when set to 1 at compile time. When it is 0 (the default), all
+/// instrumentation compiles to nothing and the statistics are always zero.
+#ifndef RBDATETIME_STATISTICS
+#define RBDATETIME_STATISTICS 0
+#endif
+
+/// A snapshot of the hot path statistics of one thread.
+typedef struct {
+    /// Number of @c RBDateTime instances created.
+    uint64_t dateTimesCreated;
+    /// Number of @c RBDuration instances created.
+    uint64_t durationsCreated;
+    /// Number of instances built in recycled memory during batch allocation.
+    uint64_t instancesRecycled;
+
+    /// Number of times date components were validated, each costing two calendar round trips.
+    uint64_t componentValidations;
+    /// Number of @c NSDate values computed from date components by the calendar.
+    uint64_t dateFromComponentsConversions;
+    /// Number of date components computed from @c NSDate values by the calendar.
+    uint64_t componentsFromDateConversions;
+    /// Number of times the @c NSDate getter found no cached value.
+    uint64_t dateCacheMisses;
+    /// Number of times the shared date formatter was reconfigured for formatting or parsing.
+    uint64_t formatterReconfigurations;
+
+    /// Nanoseconds spent validating date components. Only collected while timing is enabled.
+    ///
+    /// A validation is made of one conversion each way, so this time is also counted in
+    /// @c dateFromComponentsNanoseconds and @c componentsFromDateNanoseconds and must not be added
+    /// to them. The remaining fields do not overlap.
+    uint64_t componentValidationNanoseconds;
+    /// Nanoseconds spent computing @c NSDate values from date components. Only collected while
+    /// timing is enabled.
+    uint64_t dateFromComponentsNanoseconds;
+    /// Nanoseconds spent computing date components from @c NSDate values. Only collected while
+    /// timing is enabled.
+    uint64_t componentsFromDateNanoseconds;
+    /// Nanoseconds spent configuring the date formatter and formatting or parsing with it. Only
+    /// collected while timing is enabled. Computing the @c NSDate to format is not included.
+    uint64_t formatterNanoseconds;
+} RBDateTimeStatistics;
+
+
+@interface RBDateTime (Statistics)
+
+/// Returns whether statistics are compiled in, i.e. whether @c RBDATETIME_STATISTICS is set to 1.
++ (BOOL)statisticsAvailable;
+
+/// Returns whether the time spent in calendar and formatter calls is measured. The default is `NO`.
++ (BOOL)statisticsTimingEnabled;
+/// Sets whether the time spent in calendar and formatter calls is measured. Counters are always
+/// collected when statistics are available; timing adds two clock reads to every measured call.
+///
+/// @param  enabled         Whether to measure the time spent.
++ (void)setStatisticsTimingEnabled:(BOOL)enabled;
+
+/// Returns a snapshot of the statistics collected on the current thread.
++ (RBDateTimeStatistics)statisticsForCurrentThread;
+/// Resets the statistics collected on the current thread to zero.
++ (void)resetStatisticsForCurrentThread;
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,94 @@
+//
+//  RBDateTime
+//
+//  Copyright (c) 2015 Richard Bao. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "RBDateTimeStatistics+Private.h"
+
+#if RBDATETIME_STATISTICS
+
+#if defined(__APPLE__)
+#include <mach/mach_time.h>
+#else
+#include <time.h>
+#endif
+
+__thread RBDateTimeStatistics RBDateTimeThreadStatistics;
+atomic_bool RBDateTimeStatisticsTimingEnabled = false;
+
+uint64_t RBDateTimeStatisticsNanoseconds(void) {
+#if defined(__APPLE__)
+    static mach_timebase_info_data_t timebase;
+    if (timebase.denom == 0) {
+        mach_timebase_info(&timebase);
+    }
+
+    return mach_absolute_time() * timebase.numer / timebase.denom;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+#endif
+}
+
+#endif
+
+
+@implementation RBDateTime (Statistics)
+
++ (BOOL)statisticsAvailable {
+    return RBDATETIME_STATISTICS != 0;
+}
+
++ (BOOL)statisticsTimingEnabled {
+#if RBDATETIME_STATISTICS
+    return atomic_load_explicit(&RBDateTimeStatisticsTimingEnabled, memory_order_relaxed);
+#else
+    return NO;
+#endif
+}
+
++ (void)setStatisticsTimingEnabled:(BOOL)enabled {
+#if RBDATETIME_STATISTICS
+    atomic_store_explicit(&RBDateTimeStatisticsTimingEnabled, enabled, memory_order_relaxed);
+#endif
+}
+
++ (RBDateTimeStatistics)statisticsForCurrentThread {
+#if RBDATETIME_STATISTICS
+    return RBDateTimeThreadStatistics;
+#else
+    RBDateTimeStatistics statistics;
+    memset(&statistics, 0, sizeof(statistics));
+
+    return statistics;
+#endif
+}
+
++ (void)resetStatisticsForCurrentThread {
+#if RBDATETIME_STATISTICS
+    memset(&RBDateTimeThreadStatistics, 0, sizeof(RBDateTimeThreadStatistics));
+#endif
+}
+
+
+@end
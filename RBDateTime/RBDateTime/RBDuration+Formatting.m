@@ -0,0 +1,416 @@
+//
+//  RBDateTime
+//
+//  Copyright (c) 2015 Richard Bao. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "RBDuration.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/// All formatted durations fit in this many bytes, including the terminating NUL.
+#define RBDurationFormattingBufferSize  64
+
+typedef struct {
+    BOOL negative;
+    uint64_t days;
+    unsigned int hours;
+    unsigned int minutes;
+    unsigned int seconds;
+    unsigned int milliseconds;
+} RBDurationFields;
+
+typedef NSUInteger (*RBDurationFormatter)(RBDurationFields fields, char *buffer);
+
+/// Splits a time interval into its components in one pass, using the total number of milliseconds
+/// rounded to the nearest integer so that the carry from milliseconds to seconds is not lost.
+static RBDurationFields RBDurationFieldsFromTimeInterval(NSTimeInterval timeInterval) {
+    RBDurationFields fields;
+    double totalMilliseconds = fabs(timeInterval) * 1000;
+
+    if (isnan(totalMilliseconds)) {
+        totalMilliseconds = 0;
+    } else if (totalMilliseconds > 9e18) {
+        totalMilliseconds = 9e18;
+    }
+
+    uint64_t remainder = (uint64_t)llround(totalMilliseconds);
+
+    fields.negative = timeInterval < 0 && remainder != 0;
+    fields.milliseconds = (unsigned int)(remainder % 1000);
+    remainder /= 1000;
+    fields.seconds = (unsigned int)(remainder % 60);
+    remainder /= 60;
+    fields.minutes = (unsigned int)(remainder % 60);
+    remainder /= 60;
+    fields.hours = (unsigned int)(remainder % 24);
+    fields.days = remainder / 24;
+
+    return fields;
+}
+
+static char *RBWriteUnsigned(char *p, uint64_t value, int minimumDigits) {
+    char digits[20];
+    int count = 0;
+
+    do {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    while (count < minimumDigits) {
+        digits[count++] = '0';
+    }
+    while (count > 0) {
+        *p++ = digits[--count];
+    }
+
+    return p;
+}
+
+/// Writes the milliseconds as a decimal fraction with trailing zeros trimmed, e.g. `.5` or `.005`.
+static char *RBWriteTrimmedFraction(char *p, unsigned int milliseconds) {
+    if (milliseconds == 0) {
+        return p;
+    }
+
+    int digits = 3;
+    while (milliseconds % 10 == 0) {
+        milliseconds /= 10;
+        digits--;
+    }
+
+    *p++ = '.';
+    return RBWriteUnsigned(p, milliseconds, digits);
+}
+
+static NSUInteger RBFormatCompact(RBDurationFields fields, char *buffer) {
+    char *p = buffer;
+
+    if (fields.negative) {
+        *p++ = '-';
+    }
+
+    BOOL hasWholeSeconds = fields.days != 0 || fields.hours != 0 || fields.minutes != 0 || fields.seconds != 0;
+
+    if (!hasWholeSeconds && fields.milliseconds != 0) {
+        p = RBWriteUnsigned(p, fields.milliseconds, 1);
+        *p++ = 'm';
+        *p++ = 's';
+    } else {
+        if (fields.days != 0) {
+            p = RBWriteUnsigned(p, fields.days, 1);
+            *p++ = 'd';
+        }
+        if (fields.hours != 0) {
+            p = RBWriteUnsigned(p, fields.hours, 1);
+            *p++ = 'h';
+        }
+        if (fields.minutes != 0) {
+            p = RBWriteUnsigned(p, fields.minutes, 1);
+            *p++ = 'm';
+        }
+        if (fields.seconds != 0 || fields.milliseconds != 0 || p == buffer) {
+            p = RBWriteUnsigned(p, fields.seconds, 1);
+            p = RBWriteTrimmedFraction(p, fields.milliseconds);
+            *p++ = 's';
+        }
+    }
+
+    *p = '\0';
+    return (NSUInteger)(p - buffer);
+}
+
+static NSUInteger RBFormatClock(RBDurationFields fields, char *buffer) {
+    char *p = buffer;
+
+    if (fields.negative) {
+        *p++ = '-';
+    }
+    if (fields.days != 0) {
+        p = RBWriteUnsigned(p, fields.days, 1);
+        *p++ = 'd';
+        *p++ = ' ';
+    }
+
+    p = RBWriteUnsigned(p, fields.hours, 2);
+    *p++ = ':';
+    p = RBWriteUnsigned(p, fields.minutes, 2);
+    *p++ = ':';
+    p = RBWriteUnsigned(p, fields.seconds, 2);
+
+    if (fields.milliseconds != 0) {
+        *p++ = '.';
+        p = RBWriteUnsigned(p, fields.milliseconds, 3);
+    }
+
+    *p = '\0';
+    return (NSUInteger)(p - buffer);
+}
+
+static NSUInteger RBFormatISO8601(RBDurationFields fields, char *buffer) {
+    char *p = buffer;
+
+    if (fields.negative) {
+        *p++ = '-';
+    }
+    *p++ = 'P';
+
+    if (fields.days != 0) {
+        p = RBWriteUnsigned(p, fields.days, 1);
+        *p++ = 'D';
+    }
+
+    BOOL hasTime = fields.hours != 0 || fields.minutes != 0 || fields.seconds != 0 || fields.milliseconds != 0;
+
+    if (hasTime || fields.days == 0) {
+        *p++ = 'T';
+
+        if (fields.hours != 0) {
+            p = RBWriteUnsigned(p, fields.hours, 1);
+            *p++ = 'H';
+        }
+        if (fields.minutes != 0) {
+            p = RBWriteUnsigned(p, fields.minutes, 1);
+            *p++ = 'M';
+        }
+        if (fields.seconds != 0 || fields.milliseconds != 0 || !hasTime) {
+            p = RBWriteUnsigned(p, fields.seconds, 1);
+            p = RBWriteTrimmedFraction(p, fields.milliseconds);
+            *p++ = 'S';
+        }
+    }
+
+    *p = '\0';
+    return (NSUInteger)(p - buffer);
+}
+
+/// Parses an ISO 8601 duration of the form `[+-]PnW` or `[+-]PnDTnHnMnS` into a number of seconds.
+/// Weeks cannot be combined with any other component.
+static BOOL RBParseISO8601Duration(const char *characters, NSUInteger length, NSTimeInterval *result) {
+    static const double kSecondsForDesignator[] = { 7 * 24 * 60 * 60, 24 * 60 * 60, 60 * 60, 60, 1 };
+
+    const char *p = characters;
+    const char *end = characters + length;
+    BOOL negative = NO;
+
+    if (p < end && (*p == '+' || *p == '-')) {
+        negative = *p == '-';
+        p++;
+    }
+    if (p == end || *p != 'P') {
+        return NO;
+    }
+    p++;
+
+    BOOL inTimePart = NO;
+    BOOL hasComponent = NO;
+    BOOL hasTimeComponent = NO;
+    BOOL hasFraction = NO;
+    int lastDesignator = -1;
+    double seconds = 0;
+
+    while (p < end) {
+        if (*p == 'T') {
+            if (inTimePart) {
+                return NO;
+            }
+            inTimePart = YES;
+            p++;
+            continue;
+        }
+
+        // Only the smallest component may have a decimal fraction.
+        if (hasFraction) {
+            return NO;
+        }
+
+        uint64_t whole = 0;
+        int wholeDigits = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (wholeDigits == 18) {
+                return NO;
+            }
+            whole = whole * 10 + (uint64_t)(*p - '0');
+            wholeDigits++;
+            p++;
+        }
+        if (wholeDigits == 0) {
+            return NO;
+        }
+
+        double fraction = 0;
+        if (p < end && (*p == '.' || *p == ',')) {
+            uint64_t fractionValue = 0;
+            double fractionScale = 1;
+            int fractionDigits = 0;
+
+            p++;
+            while (p < end && *p >= '0' && *p <= '9') {
+                // Digits beyond nanoseconds carry no meaningful precision.
+                if (fractionDigits < 9) {
+                    fractionValue = fractionValue * 10 + (uint64_t)(*p - '0');
+                    fractionScale *= 10;
+                }
+                fractionDigits++;
+                p++;
+            }
+            if (fractionDigits == 0) {
+                return NO;
+            }
+
+            fraction = fractionValue / fractionScale;
+            hasFraction = YES;
+        }
+
+        if (p == end) {
+            return NO;
+        }
+
+        int designator;
+        switch (*p) {
+            case 'W': designator = 0; break;
+            case 'D': designator = 1; break;
+            case 'H': designator = 2; break;
+            case 'M': designator = 3; break;
+            case 'S': designator = 4; break;
+            default: return NO;
+        }
+
+        // Weeks and days belong to the date part, the rest to the time part. A 'M' in the date part
+        // means months, which is rejected along with years.
+        if ((designator >= 2) != inTimePart || designator <= lastDesignator) {
+            return NO;
+        }
+        if (lastDesignator == 0) {
+            return NO;
+        }
+
+        seconds += (whole + fraction) * kSecondsForDesignator[designator];
+        lastDesignator = designator;
+        hasComponent = YES;
+        hasTimeComponent = hasTimeComponent || inTimePart;
+        p++;
+    }
+
+    if (!hasComponent || (inTimePart && !hasTimeComponent)) {
+        return NO;
+    }
+
+    *result = negative ? -seconds : seconds;
+    return YES;
+}
+
+
+
+@implementation RBDuration (Formatting)
+
+#pragma mark - Formatting
+
+- (NSString *)_stringWithFormatter:(RBDurationFormatter)formatter {
+    char buffer[RBDurationFormattingBufferSize];
+    NSUInteger length = formatter(RBDurationFieldsFromTimeInterval(self.timeInterval), buffer);
+
+    return [[NSString alloc] initWithBytes:buffer length:length encoding:NSASCIIStringEncoding];
+}
+
+- (NSUInteger)_getString:(char *)buffer maxLength:(NSUInteger)maxLength formatter:(RBDurationFormatter)formatter {
+    char localBuffer[RBDurationFormattingBufferSize];
+    NSUInteger length = formatter(RBDurationFieldsFromTimeInterval(self.timeInterval), localBuffer);
+
+    if (length >= maxLength) {
+        return 0;
+    }
+
+    memcpy(buffer, localBuffer, length + 1);
+    return length;
+}
+
+- (NSString *)compactString {
+    return [self _stringWithFormatter:RBFormatCompact];
+}
+
+- (NSString *)clockString {
+    return [self _stringWithFormatter:RBFormatClock];
+}
+
+- (NSString *)ISO8601String {
+    return [self _stringWithFormatter:RBFormatISO8601];
+}
+
+- (NSUInteger)getCompactString:(char *)buffer maxLength:(NSUInteger)maxLength {
+    return [self _getString:buffer maxLength:maxLength formatter:RBFormatCompact];
+}
+
+- (NSUInteger)getClockString:(char *)buffer maxLength:(NSUInteger)maxLength {
+    return [self _getString:buffer maxLength:maxLength formatter:RBFormatClock];
+}
+
+- (NSUInteger)getISO8601String:(char *)buffer maxLength:(NSUInteger)maxLength {
+    return [self _getString:buffer maxLength:maxLength formatter:RBFormatISO8601];
+}
+
+
+
+#pragma mark - Parsing
+
++ (instancetype)durationByParsingISO8601String:(NSString *)string {
+    NSUInteger length = string.length;
+    char stackBuffer[RBDurationFormattingBufferSize];
+    char *buffer = length <= sizeof(stackBuffer) ? stackBuffer : malloc(length);
+    if (buffer == NULL) {
+        return nil;
+    }
+
+    // Conversion stops at the first character that is not ASCII, which cannot be part of a valid
+    // duration anyway. Embedded NUL characters are passed on and rejected by the parser.
+    NSUInteger usedLength = 0;
+    NSRange remainingRange = NSMakeRange(0, 0);
+    BOOL converted = [string getBytes:buffer maxLength:length usedLength:&usedLength
+                             encoding:NSASCIIStringEncoding options:0
+                                range:NSMakeRange(0, length) remainingRange:&remainingRange];
+
+    RBDuration *duration = nil;
+    if (converted && remainingRange.length == 0) {
+        duration = [RBDuration durationByParsingISO8601Characters:buffer length:usedLength];
+    }
+
+    if (buffer != stackBuffer) {
+        free(buffer);
+    }
+
+    return duration;
+}
+
++ (instancetype)durationByParsingISO8601Characters:(const char *)characters length:(NSUInteger)length {
+    NSTimeInterval timeInterval;
+
+    if (RBParseISO8601Duration(characters, length, &timeInterval)) {
+        return [[RBDuration alloc] initWithTimeInterval:timeInterval];
+    } else {
+        return nil;
+    }
+}
+
+
+@end
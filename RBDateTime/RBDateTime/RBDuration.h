@@ -166,6 +166,87 @@ NS_ASSUME_NONNULL_BEGIN
 - (BOOL)equalsTo:(RBDuration *)duration;
 
 
+@end
+
+
+
+@interface RBDuration (Formatting)
+
+#pragma mark - Formatting
+
+/// Returns a compact string representation of this duration, such as `1d2h3m4.005s`.
+///
+/// All formats round the duration to whole milliseconds. A duration whose time interval is NaN is
+/// formatted as zero, and the magnitude of an infinite or longer duration is clamped to 9e15 seconds
+/// (about 1.04e11 days).
+///
+/// Zero components are omitted and trailing zeros of the fractional seconds are trimmed. A duration
+/// shorter than one second is written in milliseconds (e.g. `5ms`), and a zero duration is `0s`.
+- (NSString *)compactString;
+/// Returns a clock-style string representation of this duration, such as `1d 02:03:04.005`.
+///
+/// The days part is omitted if it is zero, and so is the milliseconds part.
+- (NSString *)clockString;
+/// Returns string representation of this duration formatted as ISO 8601 duration `PnDTnHnMnS`,
+/// such as `P1DT2H3M4.005S`. A zero duration is `PT0S`.
+///
+/// Negative durations are prefixed with a minus sign (e.g. `-PT1H30M`).
+- (NSString *)ISO8601String;
+
+/// Writes the compact string representation (see @c -compactString) of this duration into a given
+/// buffer as a NUL-terminated ASCII string and returns the number of characters written, excluding
+/// the terminating NUL. Returns `0` and leaves the buffer untouched if it is not large enough.
+///
+/// No objects are allocated. A buffer of 64 bytes is always large enough.
+///
+/// @param  buffer          The buffer to write into.
+/// @param  maxLength       The size of the buffer in bytes, including room for the terminating NUL.
+- (NSUInteger)getCompactString:(char *)buffer maxLength:(NSUInteger)maxLength;
+/// Writes the clock-style string representation (see @c -clockString) of this duration into a
+/// given buffer as a NUL-terminated ASCII string and returns the number of characters written,
+/// excluding the terminating NUL. Returns `0` and leaves the buffer untouched if it is not large
+/// enough.
+///
+/// No objects are allocated. A buffer of 64 bytes is always large enough.
+///
+/// @param  buffer          The buffer to write into.
+/// @param  maxLength       The size of the buffer in bytes, including room for the terminating NUL.
+- (NSUInteger)getClockString:(char *)buffer maxLength:(NSUInteger)maxLength;
+/// Writes the ISO 8601 string representation (see @c -ISO8601String) of this duration into a given
+/// buffer as a NUL-terminated ASCII string and returns the number of characters written, excluding
+/// the terminating NUL. Returns `0` and leaves the buffer untouched if it is not large enough.
+///
+/// No objects are allocated. A buffer of 64 bytes is always large enough.
+///
+/// @param  buffer          The buffer to write into.
+/// @param  maxLength       The size of the buffer in bytes, including room for the terminating NUL.
+- (NSUInteger)getISO8601String:(char *)buffer maxLength:(NSUInteger)maxLength;
+
+
+#pragma mark - Parsing
+
+/// Returns a @c RBDuration instance by parsing an ISO 8601 duration string, such as `PT1H30M`,
+/// `P1DT2H3M4.005S` or `P2W`. Returns `nil` if the string is not a valid ISO 8601 duration.
+///
+/// Weeks cannot be combined with any other component, e.g. `P1W2D` is rejected.
+///
+/// The smallest component may have a decimal fraction, using either `.` or `,` as separator, and
+/// the whole duration may be prefixed with a sign. Years and months are rejected since they do not
+/// have a fixed length. Fraction digits beyond nanoseconds are ignored, so the string has no length
+/// limit, and the whole string is parsed: trailing characters, including NUL, make it invalid.
+///
+/// @param  string          The ISO 8601 duration string to parse.
++ (nullable instancetype)durationByParsingISO8601String:(NSString *)string;
+/// Returns a @c RBDuration instance by parsing an ISO 8601 duration from a given ASCII character
+/// buffer. Returns `nil` if the characters are not a valid ISO 8601 duration.
+///
+/// See @c +durationByParsingISO8601String: for the accepted syntax.
+///
+/// @param  characters      The characters to parse. They do not need to be NUL-terminated.
+/// @param  length          The number of characters to parse.
++ (nullable instancetype)durationByParsingISO8601Characters:(const char *)characters length:(NSUInteger)length;
+
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -24,6 +24,7 @@
 #import "RBDuration.h"
 
 #import "RBDateTime.h"
+#import "RBDateTimeStatistics+Private.h"
 
 @interface RBDuration () {
     NSTimeInterval _timeInterval;
@@ -47,6 +48,8 @@ static double kTimeIntervalForDay           = 60 * 60 * 24;
 - (instancetype)initWithTimeInterval:(NSTimeInterval)seconds {
     self = [super init];
     if (self) {
+        RBStatisticsIncrement(durationsCreated);
+
         _timeInterval = seconds;
     }
 
@@ -58,6 +61,8 @@ static double kTimeIntervalForDay           = 60 * 60 * 24;
                 milliseconds:(NSInteger)milliseconds {
     self = [super init];
     if (self) {
+        RBStatisticsIncrement(durationsCreated);
+
         _timeInterval = (days * kTimeIntervalForDay +
                          hours * kTimeIntervalForHour +
                          minutes * kTimeIntervalForMinute +
@@ -0,0 +1,807 @@
+//
+//  RBDateTime Benchmarks
+//
+//  Copyright (c) 2015 Richard Bao. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+#import "RBDateTime.h"
+#import "RBDateTimeBatchAllocation.h"
+#import "RBDateTimeStatistics.h"
+#import "RBDuration.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#include <malloc/malloc.h>
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+
+#pragma mark - Allocation Counting
+
+/// Number of heap allocations made by the current thread. Only glibc lets an executable interpose
+/// @c malloc portably, so allocations are reported as unavailable on other platforms.
+static __thread uint64_t RBBenchmarkAllocations = 0;
+
+#if defined(__GLIBC__)
+
+#define RBBenchmarkCountsAllocations 1
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *pointer, size_t size);
+
+void *malloc(size_t size) {
+    RBBenchmarkAllocations++;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    RBBenchmarkAllocations++;
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, size_t size) {
+    RBBenchmarkAllocations++;
+    return __libc_realloc(pointer, size);
+}
+
+#else
+
+#define RBBenchmarkCountsAllocations 0
+
+#endif
+
+
+#pragma mark - Memory Sampling
+
+#if defined(__APPLE__) || defined(__GLIBC__)
+#define RBBenchmarkMeasuresHeap 1
+#else
+#define RBBenchmarkMeasuresHeap 0
+#endif
+
+/// Returns the number of bytes the allocator currently has handed out, or 0 if unavailable.
+static uint64_t RBBenchmarkHeapBytesInUse(void) {
+#if defined(__APPLE__)
+    malloc_statistics_t statistics;
+    malloc_zone_statistics(NULL, &statistics);
+
+    return statistics.size_in_use;
+#elif defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+
+    return (uint64_t)info.uordblks + (uint64_t)info.hblkhd;
+#elif defined(__GLIBC__)
+    struct mallinfo info = mallinfo();
+
+    return (uint64_t)(unsigned int)info.uordblks + (uint64_t)(unsigned int)info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+/// Returns the resident set size of the process in KiB, or 0 if it cannot be determined.
+static uint64_t RBBenchmarkResidentKilobytes(void) {
+#if defined(__APPLE__)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+        return 0;
+    }
+
+    return info.resident_size / 1024;
+#else
+    unsigned long pages = 0;
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (statm == NULL) {
+        return 0;
+    }
+    if (fscanf(statm, "%*lu %lu", &pages) != 1) {
+        pages = 0;
+    }
+    fclose(statm);
+
+    return (uint64_t)pages * (uint64_t)sysconf(_SC_PAGESIZE) / 1024;
+#endif
+}
+
+static uint64_t RBBenchmarkNanoseconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+
+
+#pragma mark - Benchmark Cases
+
+/// Runs the measured operation the given number of times and returns a value derived from the
+/// results, so that the work cannot be optimized away.
+typedef uint64_t (^RBBenchmarkBody)(NSUInteger iterations);
+/// Creates the fixtures of a benchmark and returns its body. Called once per thread, outside of
+/// the measured time. Concurrent cases create their own calendar with @c RBBenchmarkCalendar(),
+/// since instances built without one share a single @c NSCalendar whose time zone is changed on
+/// every calendar conversion.
+typedef RBBenchmarkBody (^RBBenchmarkSetup)(void);
+
+static NSCalendar *RBBenchmarkCalendar(void) {
+    return [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+}
+
+@interface RBBenchmarkCase : NSObject
+
+@property (copy) NSString *name;
+@property (copy) RBBenchmarkSetup setup;
+/// Whether the case measures @c +performBatchAllocation:. Such cases are skipped where batch
+/// allocation is not available, since they would only repeat the plain case under another name.
+@property BOOL batchAllocation;
+/// Whether the case may run on several threads at once. Parsing and formatting @c RBDateTime share
+/// a single @c NSDateFormatter, so they are only measured on one thread.
+@property BOOL concurrent;
+
++ (instancetype)caseWithName:(NSString *)name concurrent:(BOOL)concurrent setup:(RBBenchmarkSetup)setup;
+
+@end
+
+@implementation RBBenchmarkCase
+
++ (instancetype)caseWithName:(NSString *)name concurrent:(BOOL)concurrent setup:(RBBenchmarkSetup)setup {
+    RBBenchmarkCase *benchmarkCase = [RBBenchmarkCase new];
+    benchmarkCase.name = name;
+    benchmarkCase.concurrent = concurrent;
+    benchmarkCase.setup = setup;
+
+    return benchmarkCase;
+}
+
+@end
+
+
+/// Performs one operation of a benchmark for the given iteration and returns a value derived from
+/// its result.
+typedef uint64_t (^RBBenchmarkOperation)(NSUInteger iteration);
+
+/// Returns a pair of cases for an operation creating short-lived instances: one running it as is,
+/// and one running it inside @c +performBatchAllocation:. Both drain an autorelease pool after each
+/// operation so that instances die as early as they would in a request handler.
+static NSArray *RBBenchmarkAllocationCases(NSString *name, RBBenchmarkOperation (^setup)(void)) {
+    RBBenchmarkCase *plainCase = [RBBenchmarkCase caseWithName:name concurrent:YES setup:^RBBenchmarkBody {
+        RBBenchmarkOperation operation = setup();
+        return ^uint64_t(NSUInteger iterations) {
+            uint64_t checksum = 0;
+            for (NSUInteger i = 0; i < iterations; i++) {
+                @autoreleasepool {
+                    checksum += operation(i);
+                }
+            }
+            return checksum;
+        };
+    }];
+
+    NSString *batchName = [name stringByAppendingString:@".batch"];
+    RBBenchmarkCase *batchCase = [RBBenchmarkCase caseWithName:batchName concurrent:YES setup:^RBBenchmarkBody {
+        RBBenchmarkOperation operation = setup();
+        return ^uint64_t(NSUInteger iterations) {
+            __block uint64_t checksum = 0;
+            [RBDateTime performBatchAllocation:^{
+                for (NSUInteger i = 0; i < iterations; i++) {
+                    @autoreleasepool {
+                        checksum += operation(i);
+                    }
+                }
+            }];
+            return checksum;
+        };
+    }];
+
+    batchCase.batchAllocation = YES;
+
+    return @[ plainCase, batchCase ];
+}
+
+static NSArray *RBBenchmarkAllCases(void) {
+    NSTimeZone *utcTimeZone = [NSTimeZone timeZoneWithAbbreviation:@"UTC"];
+    NSTimeZone *honoluluTimeZone = [NSTimeZone timeZoneWithName:@"Pacific/Honolulu"];
+
+    NSArray *groups = @[
+        [RBBenchmarkCase caseWithName:@"RBDateTime.construct" concurrent:YES setup:^RBBenchmarkBody {
+            NSCalendar *calendar = RBBenchmarkCalendar();
+            return ^uint64_t(NSUInteger iterations) {
+                uint64_t checksum = 0;
+                for (NSUInteger i = 0; i < iterations; i++) {
+                    RBDateTime *dateTime = [RBDateTime dateTimeWithYear:2015 month:1 day:6
+                                                                   hour:9 minute:41 second:(NSInteger)(i % 60)
+                                                               calendar:calendar];
+                    checksum += (uint64_t)dateTime.second;
+                }
+                return checksum;
+            };
+        }],
+
+        [RBBenchmarkCase caseWithName:@"RBDateTime.components" concurrent:YES setup:^RBBenchmarkBody {
+            RBDateTime *dateTime = [RBDateTime dateTimeWithYear:2015 month:1 day:6
+                                                           hour:9 minute:41 second:6 millisecond:12
+                                                       calendar:RBBenchmarkCalendar() timeZone:utcTimeZone];
+            return ^uint64_t(NSUInteger iterations) {
+                uint64_t checksum = 0;
+                for (NSUInteger i = 0; i < iterations; i++) {
+                    checksum += (uint64_t)(dateTime.year + dateTime.month + dateTime.day +
+                                           dateTime.hour + dateTime.minute + dateTime.second +
+                                           dateTime.millisecond);
+                }
+                return checksum;
+            };
+        }],
+
+        [RBBenchmarkCase caseWithName:@"RBDateTime.addDuration" concurrent:YES setup:^RBBenchmarkBody {
+            RBDateTime *dateTime = [RBDateTime dateTimeWithYear:2015 month:1 day:6 hour:9 minute:41 second:6
+                                                       calendar:RBBenchmarkCalendar()];
+            RBDuration *duration = [RBDuration durationWithDays:1 hours:2 minutes:3 seconds:4 milliseconds:5];
+            return ^uint64_t(NSUInteger iterations) {
+                uint64_t checksum = 0;
+                for (NSUInteger i = 0; i < iterations; i++) {
+                    checksum += (uint64_t)[dateTime dateTimeByAddingDuration:duration].day;
+                }
+                return checksum;
+            };
+        }],
+
+        [RBBenchmarkCase caseWithName:@"RBDateTime.inTimeZone" concurrent:YES setup:^RBBenchmarkBody {
+            RBDateTime *dateTime = [RBDateTime dateTimeWithYear:2015 month:1 day:6
+                                                           hour:9 minute:41 second:6 millisecond:0
+                                                       calendar:RBBenchmarkCalendar() timeZone:utcTimeZone];
+            return ^uint64_t(NSUInteger iterations) {
+                uint64_t checksum = 0;
+                for (NSUInteger i = 0; i < iterations; i++) {
+                    checksum += (uint64_t)[dateTime dateTimeInTimeZone:honoluluTimeZone].hour;
+                }
+                return checksum;
+            };
+        }],
+
+        [RBBenchmarkCase caseWithName:@"RBDateTime.formattedUnixTimestamp" concurrent:NO setup:^RBBenchmarkBody {
+            RBDateTime *dateTime = [RBDateTime dateTimeWithYear:2015 month:1 day:6 hour:9 minute:41 second:6];
+            return ^uint64_t(NSUInteger iterations) {
+                uint64_t checksum = 0;
+                for (NSUInteger i = 0; i < iterations; i++) {
+                    checksum += dateTime.formattedUnixTimestamp.length;
+                }
+                return checksum;
+            };
+        }],
+
+        [RBBenchmarkCase caseWithName:@"RBDateTime.parseWithFormat" concurrent:NO setup:^RBBenchmarkBody {
+            return ^uint64_t(NSUInteger iterations) {
+                uint64_t checksum = 0;
+                for (NSUInteger i = 0; i < iterations; i++) {
+                    RBDateTime *dateTime = [RBDateTime dateTimeByParsingString:@"2015-01-06 09:41:06"
+                                                                    withFormat:@"yyyy-MM-dd HH:mm:ss"];
+                    checksum += (uint64_t)dateTime.minute;
+                }
+                return checksum;
+            };
+        }],
+
+        [RBBenchmarkCase caseWithName:@"RBDuration.arithmetic" concurrent:YES setup:^RBBenchmarkBody {
+            RBDuration *duration1 = [RBDuration durationWithDays:1 hours:9 minutes:41 seconds:6 milliseconds:12];
+            RBDuration *duration2 = [RBDuration durationWithDays:6 hours:12 minutes:1 seconds:9 milliseconds:41];
+            return ^uint64_t(NSUInteger iterations) {
+                uint64_t checksum = 0;
+                for (NSUInteger i = 0; i < iterations; i++) {
+                    RBDuration *sum = [duration1 durationByAdding:duration2];
+                    RBDuration *difference = [sum durationBySubtracting:duration1];
+                    checksum += (uint64_t)([difference compareTo:duration2] + 1);
+                }
+                return checksum;
+            };
+        }],
+
+        RBBenchmarkAllocationCases(@"RBDateTime.addDays", ^RBBenchmarkOperation {
+            RBDateTime *dateTime = [RBDateTime dateTimeWithYear:2015 month:1 day:6 hour:9 minute:41 second:6
+                                                       calendar:RBBenchmarkCalendar()];
+            return ^uint64_t(NSUInteger iteration) {
+                return (uint64_t)[dateTime dateTimeByAddingDays:(NSInteger)(iteration % 365)].day;
+            };
+        }),
+
+        RBBenchmarkAllocationCases(@"RBDateTime.date", ^RBBenchmarkOperation {
+            RBDateTime *dateTime = [RBDateTime dateTimeWithYear:2015 month:1 day:6 hour:9 minute:41 second:6
+                                                       calendar:RBBenchmarkCalendar()];
+            return ^uint64_t(NSUInteger iteration) {
+                return (uint64_t)dateTime.date.day;
+            };
+        }),
+
+        RBBenchmarkAllocationCases(@"RBDateTime.timeOfDay", ^RBBenchmarkOperation {
+            RBDateTime *dateTime = [RBDateTime dateTimeWithYear:2015 month:1 day:6 hour:9 minute:41 second:6
+                                                       calendar:RBBenchmarkCalendar()];
+            return ^uint64_t(NSUInteger iteration) {
+                return (uint64_t)dateTime.timeOfDay.minutes;
+            };
+        }),
+
+        RBBenchmarkAllocationCases(@"RBDuration.fromDateToDate", ^RBBenchmarkOperation {
+            NSCalendar *calendar = RBBenchmarkCalendar();
+            RBDateTime *date1 = [RBDateTime dateTimeWithYear:2015 month:1 day:6 hour:9 minute:41 second:6
+                                                    calendar:calendar];
+            RBDateTime *date2 = [RBDateTime dateTimeWithYear:2015 month:6 day:12 hour:1 minute:6 second:9
+                                                    calendar:calendar];
+            return ^uint64_t(NSUInteger iteration) {
+                return (uint64_t)[RBDuration durationFromDate:date1 toDate:date2].days;
+            };
+        }),
+
+        [RBBenchmarkCase caseWithName:@"RBDuration.ISO8601String" concurrent:YES setup:^RBBenchmarkBody {
+            RBDuration *duration = [RBDuration durationWithDays:1 hours:2 minutes:3 seconds:4 milliseconds:5];
+            return ^uint64_t(NSUInteger iterations) {
+                uint64_t checksum = 0;
+                for (NSUInteger i = 0; i < iterations; i++) {
+                    checksum += duration.ISO8601String.length;
+                }
+                return checksum;
+            };
+        }],
+
+        [RBBenchmarkCase caseWithName:@"RBDuration.getISO8601String" concurrent:YES setup:^RBBenchmarkBody {
+            RBDuration *duration = [RBDuration durationWithDays:1 hours:2 minutes:3 seconds:4 milliseconds:5];
+            return ^uint64_t(NSUInteger iterations) {
+                uint64_t checksum = 0;
+                char buffer[64];
+                for (NSUInteger i = 0; i < iterations; i++) {
+                    checksum += [duration getISO8601String:buffer maxLength:sizeof(buffer)];
+                }
+                return checksum;
+            };
+        }],
+
+        [RBBenchmarkCase caseWithName:@"RBDuration.parseISO8601" concurrent:YES setup:^RBBenchmarkBody {
+            return ^uint64_t(NSUInteger iterations) {
+                uint64_t checksum = 0;
+                for (NSUInteger i = 0; i < iterations; i++) {
+                    checksum += (uint64_t)[RBDuration durationByParsingISO8601String:@"P1DT2H3M4.005S"].minutes;
+                }
+                return checksum;
+            };
+        }],
+    ];
+
+    // Allocation benchmarks come in pairs; flatten them into one list. The batch cases go last:
+    // the first batch installs the recycling allocator for good, and every plain case should be
+    // measured on the runtime's unmodified allocation path.
+    NSMutableArray *cases = [NSMutableArray array];
+    NSMutableArray *batchCases = [NSMutableArray array];
+    for (id group in groups) {
+        for (RBBenchmarkCase *benchmarkCase in [group isKindOfClass:[NSArray class]] ? group : @[ group ]) {
+            [benchmarkCase.batchAllocation ? batchCases : cases addObject:benchmarkCase];
+        }
+    }
+    [cases addObjectsFromArray:batchCases];
+
+    return cases;
+}
+
+
+
+#pragma mark - Runner
+
+/// Operations run between two drains of the autorelease pool.
+static const NSUInteger kIterationsPerPool = 256;
+
+@interface RBBenchmarkWorker : NSObject
+
+@property (strong) RBBenchmarkBody body;
+@property NSUInteger iterations;
+@property uint64_t elapsedNanoseconds;
+@property uint64_t allocations;
+/// Calendar conversions between @c NSDate and date components, if statistics are compiled in.
+@property uint64_t calendarConversions;
+@property uint64_t checksum;
+
+@end
+
+@implementation RBBenchmarkWorker
+
+@end
+
+
+static void RBBenchmarkMeasure(RBBenchmarkWorker *worker) {
+    RBBenchmarkBody body = worker.body;
+    NSUInteger remaining = worker.iterations;
+    uint64_t checksum = 0;
+
+    [RBDateTime resetStatisticsForCurrentThread];
+    uint64_t allocationsBefore = RBBenchmarkAllocations;
+    uint64_t start = RBBenchmarkNanoseconds();
+
+    while (remaining > 0) {
+        NSUInteger iterations = MIN(remaining, kIterationsPerPool);
+        @autoreleasepool {
+            checksum += body(iterations);
+        }
+        remaining -= iterations;
+    }
+
+    worker.elapsedNanoseconds = RBBenchmarkNanoseconds() - start;
+    worker.allocations = RBBenchmarkAllocations - allocationsBefore;
+
+    RBDateTimeStatistics statistics = [RBDateTime statisticsForCurrentThread];
+    worker.calendarConversions = statistics.dateFromComponentsConversions + statistics.componentsFromDateConversions;
+    worker.checksum = checksum;
+}
+
+
+/// Runs a benchmark case on a number of threads that are released at the same time once all of
+/// them have set up their fixtures and warmed up.
+@interface RBBenchmarkRun : NSObject {
+    RBBenchmarkCase *_benchmarkCase;
+    NSCondition *_condition;
+    NSUInteger _pendingSetups;
+    NSUInteger _pendingWorkers;
+    BOOL _started;
+    BOOL _finished;
+    BOOL _samplerRunning;
+    uint64_t _baselineHeapBytes;
+    uint64_t _peakHeapBytes;
+    uint64_t _baselineResidentKilobytes;
+    uint64_t _peakResidentKilobytes;
+}
+
+- (instancetype)initWithCase:(RBBenchmarkCase *)benchmarkCase;
+
+/// Runs the case on the given number of threads, each performing @c iterations operations after a
+/// warm-up, and returns the workers holding the measurements.
+///
+/// When @c sampleMemory is set, a sampler thread reads the heap and resident set size about every
+/// millisecond while the workers run. Sampling locks the allocator and contends with the workers,
+/// so the timings of such a run are not meaningful; it is meant as a separate pass.
+- (NSArray *)runWithThreads:(NSUInteger)threadCount iterations:(NSUInteger)iterations sampleMemory:(BOOL)sampleMemory;
+
+/// Growth of the heap bytes in use during the measured part of the last sampled run, over the value
+/// right before it started.
+@property (readonly) uint64_t peakHeapGrowthBytes;
+/// Growth of the resident set size during the measured part of the last sampled run, over the value
+/// right before it started.
+@property (readonly) uint64_t peakResidentGrowthKilobytes;
+
+@end
+
+@implementation RBBenchmarkRun
+
+- (instancetype)initWithCase:(RBBenchmarkCase *)benchmarkCase {
+    self = [super init];
+    if (self) {
+        _benchmarkCase = benchmarkCase;
+        _condition = [NSCondition new];
+    }
+
+    return self;
+}
+
+- (NSArray *)runWithThreads:(NSUInteger)threadCount iterations:(NSUInteger)iterations sampleMemory:(BOOL)sampleMemory {
+    NSMutableArray *workers = [NSMutableArray arrayWithCapacity:threadCount];
+    for (NSUInteger i = 0; i < threadCount; i++) {
+        RBBenchmarkWorker *worker = [RBBenchmarkWorker new];
+        worker.iterations = iterations;
+        [workers addObject:worker];
+    }
+
+    _pendingSetups = threadCount;
+    _pendingWorkers = threadCount;
+    _started = NO;
+    _finished = NO;
+
+    for (RBBenchmarkWorker *worker in workers) {
+        [NSThread detachNewThreadSelector:@selector(_workerMain:) toTarget:self withObject:worker];
+    }
+
+    [_condition lock];
+    while (_pendingSetups > 0) {
+        [_condition wait];
+    }
+
+    if (sampleMemory) {
+        // The sampler thread is started first so that its own stack and bookkeeping are not counted.
+        _samplerRunning = YES;
+        [NSThread detachNewThreadSelector:@selector(_samplerMain) toTarget:self withObject:nil];
+        _baselineHeapBytes = _peakHeapBytes = RBBenchmarkHeapBytesInUse();
+        _baselineResidentKilobytes = _peakResidentKilobytes = RBBenchmarkResidentKilobytes();
+    }
+
+    _started = YES;
+    [_condition broadcast];
+    while (_pendingWorkers > 0) {
+        [_condition wait];
+    }
+
+    _finished = YES;
+    while (_samplerRunning) {
+        [_condition wait];
+    }
+    [_condition unlock];
+
+    return workers;
+}
+
+- (uint64_t)peakHeapGrowthBytes {
+    return _peakHeapBytes - _baselineHeapBytes;
+}
+
+- (uint64_t)peakResidentGrowthKilobytes {
+    return _peakResidentKilobytes - _baselineResidentKilobytes;
+}
+
+- (void)_samplerMain {
+    BOOL finished = NO;
+
+    while (!finished) {
+        uint64_t heapBytes = RBBenchmarkHeapBytesInUse();
+        uint64_t residentKilobytes = RBBenchmarkResidentKilobytes();
+
+        [_condition lock];
+        _peakHeapBytes = MAX(_peakHeapBytes, heapBytes);
+        _peakResidentKilobytes = MAX(_peakResidentKilobytes, residentKilobytes);
+        finished = _finished;
+        [_condition unlock];
+
+        if (!finished) {
+            usleep(1000);
+        }
+    }
+
+    [_condition lock];
+    _samplerRunning = NO;
+    [_condition broadcast];
+    [_condition unlock];
+}
+
+- (void)_workerMain:(RBBenchmarkWorker *)worker {
+    @autoreleasepool {
+        worker.body = _benchmarkCase.setup();
+        worker.body(MAX(worker.iterations / 10, (NSUInteger)1));
+    }
+
+    [_condition lock];
+    _pendingSetups--;
+    [_condition broadcast];
+    while (!_started) {
+        [_condition wait];
+    }
+    [_condition unlock];
+
+    RBBenchmarkMeasure(worker);
+
+    [_condition lock];
+    _pendingWorkers--;
+    [_condition broadcast];
+    [_condition unlock];
+}
+
+@end
+
+
+
+#pragma mark - Main
+
+typedef NS_ENUM(NSInteger, RBBenchmarkOutputFormat) {
+    RBBenchmarkOutputFormatText,
+    RBBenchmarkOutputFormatJSON,
+    RBBenchmarkOutputFormatCSV,
+};
+
+static void RBBenchmarkPrintUsage(const char *program) {
+    fprintf(stderr,
+            "Usage: %s [--iterations N] [--threads N[,N...]] [--filter TEXT] [--json | --csv]\n"
+            "\n"
+            "  --iterations N   Operations measured per thread (default: 20000).\n"
+            "  --threads LIST   Thread counts to run concurrent cases with (default: 1,2,4,... up to\n"
+            "                   the number of active processors).\n"
+            "  --filter TEXT    Only run cases whose name contains TEXT.\n"
+            "  --json           Print results as a JSON document.\n"
+            "  --csv            Print results as CSV with a header row.\n"
+            "\n"
+            "Calendar conversions/op are reported when built with statistics=yes. Heap and RSS columns are\n"
+            "the peak growth sampled during a second, untimed run of each case, so that sampling does not\n"
+            "skew the timings. Cases ending in .batch run inside +performBatchAllocation: and are skipped\n"
+            "unless built with batch_allocation=yes on a runtime that supports it.\n",
+            program);
+}
+
+static NSString *RBBenchmarkJSONNumber(double value, BOOL available) {
+    return available ? [NSString stringWithFormat:@"%.3f", value] : @"null";
+}
+
+int main(int argc, const char *argv[]) {
+    @autoreleasepool {
+        NSUInteger iterations = 20000;
+        NSMutableArray *threadCounts = [NSMutableArray array];
+        NSString *filter = nil;
+        RBBenchmarkOutputFormat format = RBBenchmarkOutputFormatText;
+
+        for (int i = 1; i < argc; i++) {
+            if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+                iterations = (NSUInteger)strtoul(argv[++i], NULL, 10);
+            } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+                for (NSString *count in [@(argv[++i]) componentsSeparatedByString:@","]) {
+                    if (count.integerValue > 0) {
+                        [threadCounts addObject:@(count.integerValue)];
+                    }
+                }
+            } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+                filter = @(argv[++i]);
+            } else if (strcmp(argv[i], "--json") == 0) {
+                format = RBBenchmarkOutputFormatJSON;
+            } else if (strcmp(argv[i], "--csv") == 0) {
+                format = RBBenchmarkOutputFormatCSV;
+            } else {
+                RBBenchmarkPrintUsage(argv[0]);
+                return strcmp(argv[i], "--help") == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+            }
+        }
+
+        NSUInteger processorCount = [NSProcessInfo processInfo].activeProcessorCount;
+        if (threadCounts.count == 0) {
+            for (NSUInteger count = 1; count < processorCount; count *= 2) {
+                [threadCounts addObject:@(count)];
+            }
+            [threadCounts addObject:@(processorCount)];
+        }
+        if (iterations == 0) {
+            iterations = 1;
+        }
+
+        NSMutableArray *results = [NSMutableArray array];
+
+        if (format == RBBenchmarkOutputFormatText) {
+            printf("%-34s %7s %12s %14s %12s %12s %10s %10s\n",
+                   "benchmark", "threads", "ns/op", "ops/s", "allocs/op", "calendar/op", "+heap KiB", "+rss KiB");
+        }
+        if (![RBDateTime batchAllocationAvailable]) {
+            fprintf(stderr, "Batch allocation is not compiled in or not supported by this runtime; "
+                            "skipping .batch cases.\n");
+        }
+
+        for (RBBenchmarkCase *benchmarkCase in RBBenchmarkAllCases()) {
+            if (filter.length > 0 && [benchmarkCase.name rangeOfString:filter].location == NSNotFound) {
+                continue;
+            }
+            if (benchmarkCase.batchAllocation && ![RBDateTime batchAllocationAvailable]) {
+                continue;
+            }
+
+            for (NSNumber *threadCount in threadCounts) {
+                if (!benchmarkCase.concurrent && threadCount.unsignedIntegerValue > 1) {
+                    continue;
+                }
+
+                RBBenchmarkRun *run = [[RBBenchmarkRun alloc] initWithCase:benchmarkCase];
+                NSArray *workers = [run runWithThreads:threadCount.unsignedIntegerValue iterations:iterations
+                                          sampleMemory:NO];
+
+                RBBenchmarkRun *memoryRun = [[RBBenchmarkRun alloc] initWithCase:benchmarkCase];
+                [memoryRun runWithThreads:threadCount.unsignedIntegerValue iterations:iterations sampleMemory:YES];
+
+                uint64_t slowestNanoseconds = 0;
+                uint64_t totalNanoseconds = 0;
+                uint64_t totalAllocations = 0;
+                uint64_t totalCalendarConversions = 0;
+                for (RBBenchmarkWorker *worker in workers) {
+                    slowestNanoseconds = MAX(slowestNanoseconds, worker.elapsedNanoseconds);
+                    totalNanoseconds += worker.elapsedNanoseconds;
+                    totalAllocations += worker.allocations;
+                    totalCalendarConversions += worker.calendarConversions;
+                }
+
+                // Latency is averaged over what each thread observed; throughput is taken over the
+                // wall time of the slowest thread.
+                double operations = (double)iterations * workers.count;
+                NSDictionary *result = @{
+                    @"name": benchmarkCase.name,
+                    @"threads": threadCount,
+                    @"iterations": @(iterations),
+                    @"nsPerOp": @((double)totalNanoseconds / operations),
+                    @"opsPerSecond": @(operations / (slowestNanoseconds / 1e9)),
+                    @"allocationsPerOp": @((double)totalAllocations / operations),
+                    @"calendarConversionsPerOp": @((double)totalCalendarConversions / operations),
+                    @"peakHeapGrowthKilobytes": @(memoryRun.peakHeapGrowthBytes / 1024.0),
+                    @"peakResidentGrowthKilobytes": @(memoryRun.peakResidentGrowthKilobytes),
+                };
+                [results addObject:result];
+
+                if (format == RBBenchmarkOutputFormatText) {
+                    printf("%-34s %7lu %12.1f %14.0f %12s %12s %10s %10llu\n",
+                           benchmarkCase.name.UTF8String,
+                           (unsigned long)threadCount.unsignedIntegerValue,
+                           [result[@"nsPerOp"] doubleValue],
+                           [result[@"opsPerSecond"] doubleValue],
+                           RBBenchmarkCountsAllocations
+                               ? [NSString stringWithFormat:@"%.2f", [result[@"allocationsPerOp"] doubleValue]].UTF8String
+                               : "n/a",
+                           [RBDateTime statisticsAvailable]
+                               ? [NSString stringWithFormat:@"%.2f", [result[@"calendarConversionsPerOp"] doubleValue]].UTF8String
+                               : "n/a",
+                           RBBenchmarkMeasuresHeap
+                               ? [NSString stringWithFormat:@"%.0f", [result[@"peakHeapGrowthKilobytes"] doubleValue]].UTF8String
+                               : "n/a",
+                           [result[@"peakResidentGrowthKilobytes"] unsignedLongLongValue]);
+                    fflush(stdout);
+                }
+            }
+        }
+
+        if (format == RBBenchmarkOutputFormatJSON) {
+            printf("{\n  \"benchmark\": \"RBDateTime\",\n  \"timestamp\": %.0f,\n"
+                   "  \"processorCount\": %lu,\n  \"iterations\": %lu,\n  \"batchAllocationAvailable\": %s,\n"
+                   "  \"results\": [\n",
+                   [NSDate date].timeIntervalSince1970, (unsigned long)processorCount, (unsigned long)iterations,
+                   [RBDateTime batchAllocationAvailable] ? "true" : "false");
+            for (NSUInteger i = 0; i < results.count; i++) {
+                NSDictionary *result = results[i];
+                printf("    {\"name\": \"%s\", \"threads\": %lu, \"nsPerOp\": %s, \"opsPerSecond\": %s, "
+                       "\"allocationsPerOp\": %s, \"calendarConversionsPerOp\": %s, "
+                       "\"peakHeapGrowthKilobytes\": %s, \"peakResidentGrowthKilobytes\": %llu}%s\n",
+                       [result[@"name"] UTF8String],
+                       (unsigned long)[result[@"threads"] unsignedIntegerValue],
+                       RBBenchmarkJSONNumber([result[@"nsPerOp"] doubleValue], YES).UTF8String,
+                       RBBenchmarkJSONNumber([result[@"opsPerSecond"] doubleValue], YES).UTF8String,
+                       RBBenchmarkJSONNumber([result[@"allocationsPerOp"] doubleValue],
+                                             RBBenchmarkCountsAllocations).UTF8String,
+                       RBBenchmarkJSONNumber([result[@"calendarConversionsPerOp"] doubleValue],
+                                             [RBDateTime statisticsAvailable]).UTF8String,
+                       RBBenchmarkJSONNumber([result[@"peakHeapGrowthKilobytes"] doubleValue],
+                                             RBBenchmarkMeasuresHeap).UTF8String,
+                       [result[@"peakResidentGrowthKilobytes"] unsignedLongLongValue],
+                       i + 1 < results.count ? "," : "");
+            }
+            printf("  ]\n}\n");
+        } else if (format == RBBenchmarkOutputFormatCSV) {
+            printf("name,threads,iterations,ns_per_op,ops_per_second,allocations_per_op,calendar_conversions_per_op,"
+                   "peak_heap_growth_kilobytes,peak_resident_growth_kilobytes\n");
+            for (NSDictionary *result in results) {
+                printf("%s,%lu,%lu,%.3f,%.3f,%s,%s,%s,%llu\n",
+                       [result[@"name"] UTF8String],
+                       (unsigned long)[result[@"threads"] unsignedIntegerValue],
+                       (unsigned long)iterations,
+                       [result[@"nsPerOp"] doubleValue],
+                       [result[@"opsPerSecond"] doubleValue],
+                       RBBenchmarkCountsAllocations
+                           ? [NSString stringWithFormat:@"%.3f", [result[@"allocationsPerOp"] doubleValue]].UTF8String
+                           : "",
+                       [RBDateTime statisticsAvailable]
+                           ? [NSString stringWithFormat:@"%.3f", [result[@"calendarConversionsPerOp"] doubleValue]].UTF8String
+                           : "",
+                       RBBenchmarkMeasuresHeap
+                           ? [NSString stringWithFormat:@"%.3f", [result[@"peakHeapGrowthKilobytes"] doubleValue]].UTF8String
+                           : "",
+                       [result[@"peakResidentGrowthKilobytes"] unsignedLongLongValue]);
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,99 @@
+//
+//  RBDateTime Unit Tests
+//
+//  Copyright (c) 2015 Richard Bao. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <XCTest/XCTest.h>
+
+#import "RBDateTime.h"
+#import "RBDateTimeBatchAllocation.h"
+#import "RBDateTimeStatistics.h"
+
+@interface RBDateTimeBatchAllocationTests : XCTestCase
+
+@end
+
+@implementation RBDateTimeBatchAllocationTests
+
+static NSTimeZone *UtcTime = nil;
+
++ (void)setUp {
+    UtcTime = [NSTimeZone timeZoneWithAbbreviation:@"UTC"];
+}
+
+- (void)testRecycledInstancesAreValid {
+    RBDateTime *date = [RBDateTime dateTimeWithYear:2015 month:1 day:6 hour:9 minute:41 second:6
+                                           timeZone:UtcTime];
+    [RBDateTime resetStatisticsForCurrentThread];
+
+    [RBDateTime performBatchAllocation:^{
+        for (NSInteger days = 1; days <= 100; days++) {
+            @autoreleasepool {
+                RBDateTime *later = [date dateTimeByAddingDays:days];
+                RBDuration *duration = [RBDuration durationFromDate:date toDate:later];
+
+                XCTAssertEqual(duration.days, days);
+                XCTAssertEqual(later.hour, 9);
+                XCTAssertEqual(later.minute, 41);
+            }
+        }
+    }];
+
+    if ([RBDateTime batchAllocationAvailable] && [RBDateTime statisticsAvailable]) {
+        XCTAssertGreaterThan([RBDateTime statisticsForCurrentThread].instancesRecycled, 0);
+    }
+}
+
+- (void)testInstancesOutliveBatch {
+    __block RBDateTime *date = nil;
+    __block RBDuration *duration = nil;
+
+    [RBDateTime performBatchAllocation:^{
+        for (NSInteger i = 0; i < 10; i++) {
+            @autoreleasepool {
+                date = [RBDateTime dateTimeWithYear:2015 month:1 day:6 + i];
+                duration = [RBDuration durationWithDays:i];
+            }
+        }
+    }];
+
+    XCTAssertEqual(date.day, 15);
+    XCTAssertEqual(duration.days, 9);
+    XCTAssertEqual([date dateTimeByAddingDuration:duration].day, 24);
+}
+
+- (void)testNestedBatches {
+    __block NSInteger day = 0;
+
+    [RBDateTime performBatchAllocation:^{
+        [RBDateTime performBatchAllocation:^{
+            @autoreleasepool {
+                [RBDateTime dateTimeWithYear:2015 month:1 day:6];
+            }
+        }];
+
+        day = [RBDateTime dateTimeWithYear:2015 month:1 day:7].day;
+    }];
+
+    XCTAssertEqual(day, 7);
+}
+
+@end
@@ -0,0 +1,121 @@
+//
+//  RBDateTime Unit Tests
+//
+//  Copyright (c) 2015 Richard Bao. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <XCTest/XCTest.h>
+
+#import "RBDateTime.h"
+#import "RBDateTimeStatistics.h"
+
+@interface RBDateTimeStatisticsTests : XCTestCase {
+    uint64_t _backgroundDateTimesCreated;
+}
+
+@end
+
+@implementation RBDateTimeStatisticsTests
+
+- (void)setUp {
+    [super setUp];
+    [RBDateTime resetStatisticsForCurrentThread];
+}
+
+- (void)tearDown {
+    [RBDateTime setStatisticsTimingEnabled:NO];
+    [super tearDown];
+}
+
+- (void)testCounters {
+    RBDateTime *date = [RBDateTime dateTimeWithYear:2015 month:1 day:6 hour:9 minute:41 second:6];
+    [date dateTimeByAddingDays:1];
+    [RBDuration durationWithDays:1];
+    [date formattedUnixTimestampUTC];
+
+    RBDateTimeStatistics statistics = [RBDateTime statisticsForCurrentThread];
+
+    if ([RBDateTime statisticsAvailable]) {
+        XCTAssertEqual(statistics.dateTimesCreated, 2);
+        XCTAssertEqual(statistics.durationsCreated, 1);
+        XCTAssertEqual(statistics.componentValidations, 2);
+        XCTAssertEqual(statistics.dateFromComponentsConversions, 2);
+        XCTAssertEqual(statistics.componentsFromDateConversions, 2);
+        XCTAssertEqual(statistics.dateCacheMisses, 0);
+        XCTAssertEqual(statistics.formatterReconfigurations, 1);
+        XCTAssertEqual(statistics.componentValidationNanoseconds, 0);
+    } else {
+        XCTAssertEqual(statistics.dateTimesCreated, 0);
+        XCTAssertEqual(statistics.componentValidations, 0);
+        XCTAssertEqual(statistics.formatterReconfigurations, 0);
+    }
+}
+
+- (void)testReset {
+    [RBDateTime dateTimeWithYear:2015 month:1 day:6];
+    [RBDateTime resetStatisticsForCurrentThread];
+
+    RBDateTimeStatistics statistics = [RBDateTime statisticsForCurrentThread];
+
+    XCTAssertEqual(statistics.dateTimesCreated, 0);
+    XCTAssertEqual(statistics.componentValidations, 0);
+}
+
+- (void)testTiming {
+    [RBDateTime setStatisticsTimingEnabled:YES];
+    XCTAssertEqual([RBDateTime statisticsTimingEnabled], [RBDateTime statisticsAvailable]);
+
+    [RBDateTime dateTimeWithYear:2015 month:1 day:6];
+
+    RBDateTimeStatistics statistics = [RBDateTime statisticsForCurrentThread];
+
+    if ([RBDateTime statisticsAvailable]) {
+        XCTAssertGreaterThan(statistics.componentValidationNanoseconds, 0);
+        XCTAssertGreaterThanOrEqual(statistics.componentValidationNanoseconds,
+                                    statistics.dateFromComponentsNanoseconds);
+    } else {
+        XCTAssertEqual(statistics.componentValidationNanoseconds, 0);
+    }
+}
+
+- (void)testStatisticsArePerThread {
+    [RBDateTime dateTimeWithYear:2015 month:1 day:6];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Background thread"];
+    _backgroundDateTimesCreated = 1;
+
+    // A new thread is guaranteed to start with no statistics, unlike a reused GCD worker thread.
+    NSThread *thread = [[NSThread alloc] initWithTarget:self
+                                               selector:@selector(_readStatisticsOnBackgroundThread:)
+                                                 object:expectation];
+    [thread start];
+
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertEqual(_backgroundDateTimesCreated, 0);
+    XCTAssertEqual([RBDateTime statisticsForCurrentThread].dateTimesCreated,
+                   [RBDateTime statisticsAvailable] ? 1 : 0);
+}
+
+- (void)_readStatisticsOnBackgroundThread:(XCTestExpectation *)expectation {
+    _backgroundDateTimesCreated = [RBDateTime statisticsForCurrentThread].dateTimesCreated;
+    [expectation fulfill];
+}
+
+@end
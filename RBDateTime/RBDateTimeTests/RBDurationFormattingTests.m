@@ -0,0 +1,131 @@
+//
+//  RBDateTime Unit Tests
+//
+//  Copyright (c) 2015 Richard Bao. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <XCTest/XCTest.h>
+
+#import "RBDuration.h"
+
+#define XCTAssertStringEqual(string1, string2) \
+    XCTAssert([string1 isEqualToString:string2], @"\"%@\" is not equal to \"%@\"", string1, string2)
+
+@interface RBDurationFormattingTests : XCTestCase
+
+@end
+
+@implementation RBDurationFormattingTests
+
+- (void)testCompactString {
+    XCTAssertStringEqual([RBDuration durationWithDays:1 hours:2 minutes:3 seconds:4 milliseconds:5].compactString,
+                         @"1d2h3m4.005s");
+    XCTAssertStringEqual([RBDuration durationWithMinutes:-90].compactString, @"-1h30m");
+    XCTAssertStringEqual([RBDuration durationWithMilliseconds:5].compactString, @"5ms");
+    XCTAssertStringEqual([RBDuration durationWithMilliseconds:1500].compactString, @"1.5s");
+    XCTAssertStringEqual([RBDuration durationWithSeconds:0].compactString, @"0s");
+}
+
+- (void)testClockString {
+    XCTAssertStringEqual([RBDuration durationWithDays:1 hours:2 minutes:3 seconds:4 milliseconds:5].clockString,
+                         @"1d 02:03:04.005");
+    XCTAssertStringEqual([RBDuration durationWithHours:9 minutes:41 seconds:6].clockString, @"09:41:06");
+    XCTAssertStringEqual([RBDuration durationWithMinutes:-90].clockString, @"-01:30:00");
+    XCTAssertStringEqual([RBDuration durationWithSeconds:0].clockString, @"00:00:00");
+}
+
+- (void)testISO8601String {
+    XCTAssertStringEqual([RBDuration durationWithDays:1 hours:2 minutes:3 seconds:4 milliseconds:5].ISO8601String,
+                         @"P1DT2H3M4.005S");
+    XCTAssertStringEqual([RBDuration durationWithMinutes:90].ISO8601String, @"PT1H30M");
+    XCTAssertStringEqual([RBDuration durationWithMinutes:-90].ISO8601String, @"-PT1H30M");
+    XCTAssertStringEqual([RBDuration durationWithDays:3].ISO8601String, @"P3D");
+    XCTAssertStringEqual([RBDuration durationWithMilliseconds:500].ISO8601String, @"PT0.5S");
+    XCTAssertStringEqual([RBDuration durationWithSeconds:0].ISO8601String, @"PT0S");
+}
+
+- (void)testMillisecondsCarry {
+    RBDuration *duration = [[RBDuration alloc] initWithTimeInterval:59.9996];
+
+    XCTAssertStringEqual(duration.compactString, @"1m");
+    XCTAssertStringEqual(duration.clockString, @"00:01:00");
+    XCTAssertStringEqual(duration.ISO8601String, @"PT1M");
+}
+
+- (void)testGetStringIntoBuffer {
+    RBDuration *duration = [RBDuration durationWithDays:1 hours:2 minutes:3 seconds:4 milliseconds:5];
+    char buffer[64];
+
+    XCTAssertEqual([duration getISO8601String:buffer maxLength:sizeof(buffer)], 14);
+    XCTAssertEqual(strcmp(buffer, "P1DT2H3M4.005S"), 0);
+    XCTAssertEqual([duration getClockString:buffer maxLength:sizeof(buffer)], 15);
+    XCTAssertEqual(strcmp(buffer, "1d 02:03:04.005"), 0);
+    XCTAssertEqual([duration getCompactString:buffer maxLength:sizeof(buffer)], 12);
+    XCTAssertEqual(strcmp(buffer, "1d2h3m4.005s"), 0);
+
+    // Not enough room for the terminating NUL.
+    XCTAssertEqual([duration getCompactString:buffer maxLength:12], 0);
+    XCTAssertEqual([duration getCompactString:buffer maxLength:13], 12);
+}
+
+- (void)testParsingISO8601String {
+    XCTAssertEqual([RBDuration durationByParsingISO8601String:@"PT1H30M"].timeInterval, 90 * 60);
+    XCTAssertEqual([RBDuration durationByParsingISO8601String:@"P2W"].timeInterval, 14 * 24 * 60 * 60);
+    XCTAssertEqual([RBDuration durationByParsingISO8601String:@"-P1D"].timeInterval, -24 * 60 * 60);
+    XCTAssertEqual([RBDuration durationByParsingISO8601String:@"PT0,5S"].timeInterval, 0.5);
+    XCTAssertEqual([RBDuration durationByParsingISO8601String:@"PT1.5H"].timeInterval, 90 * 60);
+
+    RBDuration *parsed = [RBDuration durationByParsingISO8601String:@"P1DT2H3M4.005S"];
+    XCTAssertTrue([parsed equalsTo:[RBDuration durationWithDays:1 hours:2 minutes:3 seconds:4 milliseconds:5]]);
+}
+
+- (void)testParsingLongISO8601String {
+    NSString *fraction = [@"PT1.5" stringByPaddingToLength:80 withString:@"0" startingAtIndex:0];
+    NSString *string = [fraction stringByAppendingString:@"S"];
+
+    XCTAssertEqual([RBDuration durationByParsingISO8601String:string].timeInterval, 1.5);
+}
+
+- (void)testParsingInvalidISO8601String {
+    NSArray *invalidStrings = @[ @"", @"P", @"PT", @"P1DT", @"1D", @"PT5", @"PT.5S", @"PT5.S",
+                                 @"P1Y", @"P1M", @"PT30M1H", @"PT1H1H", @"PT1.5H30M", @"P1H", @"PT1D",
+                                 @"P1W2D", @"P1WT1H", @"PT1H\u00e9",
+                                 [[NSString alloc] initWithBytes:"PT1H\0junk" length:9 encoding:NSASCIIStringEncoding] ];
+
+    for (NSString *string in invalidStrings) {
+        XCTAssertNil([RBDuration durationByParsingISO8601String:string], @"\"%@\" should not be parsed", string);
+    }
+}
+
+- (void)testParsingISO8601Characters {
+    const char *characters = "PT1H30M, PT2H";
+
+    XCTAssertEqual([RBDuration durationByParsingISO8601Characters:characters length:7].timeInterval, 90 * 60);
+    XCTAssertNil([RBDuration durationByParsingISO8601Characters:characters length:8]);
+}
+
+- (void)testRoundTrip {
+    RBDuration *duration = [RBDuration durationWithDays:-156 hours:-15 minutes:-25 seconds:-3 milliseconds:-29];
+    RBDuration *parsed = [RBDuration durationByParsingISO8601String:duration.ISO8601String];
+
+    XCTAssertTrue([parsed equalsTo:duration]);
+}
+
+@end